@@ -5,21 +5,550 @@
 #include <string>
 #include <algorithm>  // For std::any_of
 #include <unordered_map>
+#include <memory>
+#include <limits>
+#include <cstdint>
+#include <chrono>
+#include <deque>
+#include <streambuf>
+#include <sys/resource.h>
 
 #include "lexer.h"
 
+// ==================== Runtime Statistics ====================
+
+// Counters are compiled in by default; build with -DECOLANG_STATS=0 to remove
+// every hook so the interpreter pays nothing for them.
+#ifndef ECOLANG_STATS
+#define ECOLANG_STATS 1
+#endif
+
+// Scheduler slice latencies go into a fixed log-linear histogram: exact
+// buckets below 16us, then 8 buckets per power of two (within 12.5%), so its
+// size does not grow with the number of slices
+constexpr size_t SLICE_EXACT_BUCKETS = 16;
+constexpr size_t SLICE_SUB_BUCKETS = 8;
+constexpr size_t SLICE_BUCKETS = SLICE_EXACT_BUCKETS + (64 - 4) * SLICE_SUB_BUCKETS;
+
+struct RuntimeStats {
+    // Phase timings in microseconds
+    uint64_t loadMicros;
+    uint64_t lexMicros;
+    uint64_t parseMicros;
+    uint64_t evalMicros;
+
+    uint64_t tokens;
+    uint64_t astNodes;
+    uint64_t internLookups;  // Interned node requests made by the parser
+    uint64_t internHits;     // Requests answered with an existing node
+    uint64_t lazyBlocksDeferred;      // Bodies skipped by the lazy parser
+    uint64_t lazyBlocksMaterialized;  // Deferred bodies parsed on first execution
+    uint64_t astAndBigIntBytes;  // Heap bytes of AST nodes and promoted BigInts only
+    uint64_t statementsExecuted;
+    uint64_t loopIterations;
+    uint64_t statementsResumed;  // Top-level statements restored from checkpoints
+
+    uint64_t sliceCount;
+    uint64_t sliceMaxMicros;
+    uint64_t sliceBuckets[SLICE_BUCKETS];
+};
+
+// Zero-initialised before any dynamic initialisation, so the hooks are safe
+// to use from static constructors
+RuntimeStats runtimeStats;
+
+#if ECOLANG_STATS
+#define STAT_INC(field) (++runtimeStats.field)
+#define STAT_ADD(field, amount) (runtimeStats.field += (amount))
+
+// Adds the lifetime of the enclosing scope to one of the phase timings
+class PhaseTimer {
+public:
+    explicit PhaseTimer(uint64_t& target)
+        : target(target), start(std::chrono::steady_clock::now()) {}
+
+    ~PhaseTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        target += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    }
+
+private:
+    uint64_t& target;
+    std::chrono::steady_clock::time_point start;
+};
+#else
+#define STAT_INC(field) ((void)0)
+#define STAT_ADD(field, amount) ((void)0)
+
+class PhaseTimer {
+public:
+    explicit PhaseTimer(uint64_t&) {}
+};
+#endif
+
+// Peak resident set size of this process in bytes
+uint64_t peakResidentBytes() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss;  // Already in bytes on macOS
+#else
+    return uint64_t(usage.ru_maxrss) * 1024;  // Kilobytes on Linux
+#endif
+}
+
+// Interned node requests per node actually allocated (1 means no sharing)
+double internDedupRatio() {
+    uint64_t unique = runtimeStats.internLookups - runtimeStats.internHits;
+    return unique ? double(runtimeStats.internLookups) / unique : 1.0;
+}
+
+size_t sliceBucket(uint64_t micros) {
+    if (micros < SLICE_EXACT_BUCKETS) {
+        return micros;
+    }
+    size_t exponent = 63 - __builtin_clzll(micros);  // At least 4 here
+    size_t sub = (micros >> (exponent - 3)) & (SLICE_SUB_BUCKETS - 1);
+    return SLICE_EXACT_BUCKETS + (exponent - 4) * SLICE_SUB_BUCKETS + sub;
+}
+
+// Largest latency that falls into a bucket
+uint64_t sliceBucketUpperBound(size_t bucket) {
+    if (bucket < SLICE_EXACT_BUCKETS) {
+        return bucket;
+    }
+    size_t exponent = (bucket - SLICE_EXACT_BUCKETS) / SLICE_SUB_BUCKETS + 4;
+    size_t sub = (bucket - SLICE_EXACT_BUCKETS) % SLICE_SUB_BUCKETS;
+    uint64_t width = uint64_t(1) << (exponent - 3);
+    return (SLICE_SUB_BUCKETS + sub) * width + width - 1;
+}
+
+void recordSliceLatency(uint64_t micros) {
+#if ECOLANG_STATS
+    runtimeStats.sliceBuckets[sliceBucket(micros)]++;
+    runtimeStats.sliceCount++;
+    runtimeStats.sliceMaxMicros = std::max(runtimeStats.sliceMaxMicros, micros);
+#else
+    (void)micros;
+#endif
+}
+
+// Nearest-rank percentile of the slice latencies, to histogram precision
+uint64_t sliceLatencyPercentile(double percentile) {
+    uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * runtimeStats.sliceCount + 0.999999);
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < SLICE_BUCKETS; bucket++) {
+        seen += runtimeStats.sliceBuckets[bucket];
+        if (seen >= rank) {
+            return std::min(sliceBucketUpperBound(bucket), runtimeStats.sliceMaxMicros);
+        }
+    }
+    return runtimeStats.sliceMaxMicros;
+}
+
+void printStatsJson(std::ostream& out, int exitStatus) {
+    out << "{\"exit_status\":" << exitStatus
+        << ",\"timings_us\":{"
+        << "\"load\":" << runtimeStats.loadMicros
+        << ",\"lex\":" << runtimeStats.lexMicros
+        << ",\"parse\":" << runtimeStats.parseMicros
+        << ",\"eval\":" << runtimeStats.evalMicros
+        << "},\"tokens\":" << runtimeStats.tokens
+        << ",\"ast_nodes\":" << runtimeStats.astNodes
+        << ",\"ast_intern\":{\"lookups\":" << runtimeStats.internLookups
+        << ",\"hits\":" << runtimeStats.internHits
+        << ",\"dedup_ratio\":" << internDedupRatio() << "}"
+        << ",\"lazy_blocks\":{\"deferred\":" << runtimeStats.lazyBlocksDeferred
+        << ",\"materialized\":" << runtimeStats.lazyBlocksMaterialized << "}"
+        << ",\"ast_and_bigint_bytes\":" << runtimeStats.astAndBigIntBytes
+        << ",\"peak_rss_bytes\":" << peakResidentBytes()
+        << ",\"statements_executed\":" << runtimeStats.statementsExecuted
+        << ",\"loop_iterations\":" << runtimeStats.loopIterations
+        << ",\"statements_resumed\":" << runtimeStats.statementsResumed;
+
+    if (runtimeStats.sliceCount > 0) {
+        out << ",\"scheduler_slices\":{\"count\":" << runtimeStats.sliceCount
+            << ",\"p50_us\":" << sliceLatencyPercentile(50)
+            << ",\"p90_us\":" << sliceLatencyPercentile(90)
+            << ",\"p99_us\":" << sliceLatencyPercentile(99)
+            << ",\"max_us\":" << runtimeStats.sliceMaxMicros << "}";
+    }
+    out << "}" << std::endl;
+}
+
+// ==================== Values ====================
+
+// Arbitrary-precision integer used once a result no longer fits in 64 bits.
+// Stored as sign + magnitude with 32-bit limbs, least significant first.
+struct BigInt {
+    bool negative = false;
+    std::vector<uint32_t> limbs;  // Empty means zero; never has leading zero limbs
+
+    static BigInt fromInt64(int64_t value) {
+        BigInt result;
+        result.negative = value < 0;
+        // Negate in unsigned space so INT64_MIN does not overflow
+        uint64_t magnitude = result.negative ? 0 - static_cast<uint64_t>(value)
+                                             : static_cast<uint64_t>(value);
+        while (magnitude) {
+            result.limbs.push_back(static_cast<uint32_t>(magnitude));
+            magnitude >>= 32;
+        }
+        return result;
+    }
+
+    static BigInt fromString(const std::string& digits) {
+        BigInt result;
+        for (char digit : digits) {
+            multiplyAddSmall(result.limbs, 10, digit - '0');
+        }
+        return result;
+    }
+
+    bool isZero() const {
+        return limbs.empty();
+    }
+
+    bool fitsInt64() const {
+        if (limbs.size() > 2) {
+            return false;
+        }
+        uint64_t magnitude = toMagnitude64();
+        return negative ? magnitude <= (uint64_t(1) << 63) : magnitude < (uint64_t(1) << 63);
+    }
+
+    int64_t toInt64() const {
+        uint64_t magnitude = toMagnitude64();
+        return negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    }
+
+    std::string toString() const {
+        if (isZero()) {
+            return "0";
+        }
+
+        // Peel off base-10^9 chunks from the least significant end
+        std::vector<uint32_t> remaining = limbs;
+        std::vector<uint32_t> chunks;
+        while (!remaining.empty()) {
+            chunks.push_back(divideSmall(remaining, 1000000000));
+        }
+
+        std::string result = negative ? "-" : "";
+        result += std::to_string(chunks.back());
+        for (size_t i = chunks.size() - 1; i-- > 0;) {
+            std::string chunk = std::to_string(chunks[i]);
+            result += std::string(9 - chunk.size(), '0') + chunk;
+        }
+        return result;
+    }
+
+    static int compare(const BigInt& a, const BigInt& b) {
+        if (a.negative != b.negative) {
+            return a.negative ? -1 : 1;
+        }
+        int magnitudeOrder = compareMagnitude(a.limbs, b.limbs);
+        return a.negative ? -magnitudeOrder : magnitudeOrder;
+    }
+
+    static BigInt add(const BigInt& a, const BigInt& b) {
+        BigInt result;
+        if (a.negative == b.negative) {
+            result.limbs = addMagnitude(a.limbs, b.limbs);
+            result.negative = a.negative;
+        } else if (compareMagnitude(a.limbs, b.limbs) >= 0) {
+            result.limbs = subtractMagnitude(a.limbs, b.limbs);
+            result.negative = a.negative;
+        } else {
+            result.limbs = subtractMagnitude(b.limbs, a.limbs);
+            result.negative = b.negative;
+        }
+        result.normalize();
+        return result;
+    }
+
+    static BigInt subtract(const BigInt& a, const BigInt& b) {
+        BigInt negated = b;
+        negated.negative = !b.negative;
+        return add(a, negated);
+    }
+
+    static BigInt multiply(const BigInt& a, const BigInt& b) {
+        BigInt result;
+        if (a.isZero() || b.isZero()) {
+            return result;
+        }
+
+        result.limbs.assign(a.limbs.size() + b.limbs.size(), 0);
+        for (size_t i = 0; i < a.limbs.size(); i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < b.limbs.size(); j++) {
+                uint64_t product = uint64_t(a.limbs[i]) * b.limbs[j] + result.limbs[i + j] + carry;
+                result.limbs[i + j] = static_cast<uint32_t>(product);
+                carry = product >> 32;
+            }
+            result.limbs[i + b.limbs.size()] = static_cast<uint32_t>(carry);
+        }
+        result.negative = a.negative != b.negative;
+        result.normalize();
+        return result;
+    }
+
+    // Truncating division, matching C++ integer semantics. Caller checks for zero.
+    static BigInt divide(const BigInt& a, const BigInt& b) {
+        BigInt result;
+        if (b.limbs.size() == 1) {
+            result.limbs = a.limbs;
+            divideSmall(result.limbs, b.limbs[0]);
+        } else {
+            result.limbs = divideMagnitude(a.limbs, b.limbs);
+        }
+        result.negative = a.negative != b.negative;
+        result.normalize();
+        return result;
+    }
+
+private:
+    uint64_t toMagnitude64() const {
+        uint64_t magnitude = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            magnitude = (magnitude << 32) | limbs[i];
+        }
+        return magnitude;
+    }
+
+    void normalize() {
+        while (!limbs.empty() && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+        if (limbs.empty()) {
+            negative = false;
+        }
+    }
+
+    static void multiplyAddSmall(std::vector<uint32_t>& limbs, uint32_t factor, uint32_t addend) {
+        uint64_t carry = addend;
+        for (uint32_t& limb : limbs) {
+            uint64_t product = uint64_t(limb) * factor + carry;
+            limb = static_cast<uint32_t>(product);
+            carry = product >> 32;
+        }
+        if (carry) {
+            limbs.push_back(static_cast<uint32_t>(carry));
+        }
+    }
+
+    // Divides limbs in place and returns the remainder
+    static uint32_t divideSmall(std::vector<uint32_t>& limbs, uint32_t divisor) {
+        uint64_t remainder = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            uint64_t current = (remainder << 32) | limbs[i];
+            limbs[i] = static_cast<uint32_t>(current / divisor);
+            remainder = current % divisor;
+        }
+        while (!limbs.empty() && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+        return static_cast<uint32_t>(remainder);
+    }
+
+    static int compareMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        if (a.size() != b.size()) {
+            return a.size() < b.size() ? -1 : 1;
+        }
+        for (size_t i = a.size(); i-- > 0;) {
+            if (a[i] != b[i]) {
+                return a[i] < b[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    static std::vector<uint32_t> addMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        const std::vector<uint32_t>& longer = a.size() >= b.size() ? a : b;
+        const std::vector<uint32_t>& shorter = a.size() >= b.size() ? b : a;
+        std::vector<uint32_t> result;
+        result.reserve(longer.size() + 1);
+
+        uint64_t carry = 0;
+        for (size_t i = 0; i < longer.size(); i++) {
+            uint64_t sum = uint64_t(longer[i]) + (i < shorter.size() ? shorter[i] : 0) + carry;
+            result.push_back(static_cast<uint32_t>(sum));
+            carry = sum >> 32;
+        }
+        if (carry) {
+            result.push_back(static_cast<uint32_t>(carry));
+        }
+        return result;
+    }
+
+    // Requires |a| >= |b|
+    static std::vector<uint32_t> subtractMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        std::vector<uint32_t> result(a.size());
+        int64_t borrow = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+            int64_t difference = int64_t(a[i]) - (i < b.size() ? b[i] : 0) - borrow;
+            borrow = difference < 0;
+            result[i] = static_cast<uint32_t>(difference + (borrow << 32));
+        }
+        return result;
+    }
+
+    // Shift-subtract long division; only used for multi-limb divisors
+    static std::vector<uint32_t> divideMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        std::vector<uint32_t> quotient(a.size(), 0);
+        std::vector<uint32_t> remainder;
+
+        for (size_t bit = a.size() * 32; bit-- > 0;) {
+            // remainder = remainder * 2 + next bit of a
+            multiplyAddSmall(remainder, 2, (a[bit / 32] >> (bit % 32)) & 1);
+            if (compareMagnitude(remainder, b) >= 0) {
+                remainder = subtractMagnitude(remainder, b);
+                while (!remainder.empty() && remainder.back() == 0) {
+                    remainder.pop_back();
+                }
+                quotient[bit / 32] |= uint32_t(1) << (bit % 32);
+            }
+        }
+        return quotient;
+    }
+};
+
+// Runtime integer value. Values that fit in 64 bits are stored inline; only
+// results that overflow are promoted to a heap-allocated BigInt, and those are
+// demoted back as soon as they fit again so the fast path stays the common one.
+class Value {
+public:
+    Value() : small(0) {}
+    Value(int64_t small) : small(small) {}
+
+    explicit Value(const BigInt& value) : small(0) {
+        if (value.fitsInt64()) {
+            small = value.toInt64();
+        } else {
+            STAT_ADD(astAndBigIntBytes, sizeof(BigInt) + value.limbs.size() * sizeof(uint32_t));
+            big = std::make_shared<const BigInt>(value);
+        }
+    }
+
+    bool isSmall() const {
+        return !big;
+    }
+
+    int64_t asSmall() const {
+        return small;
+    }
+
+    BigInt toBig() const {
+        return big ? *big : BigInt::fromInt64(small);
+    }
+
+    // A promoted value never fits in 64 bits, so it can never be zero
+    bool isTruthy() const {
+        return big || small != 0;
+    }
+
+    std::string toString() const {
+        return big ? big->toString() : std::to_string(small);
+    }
+
+private:
+    int64_t small;
+    std::shared_ptr<const BigInt> big;
+};
+
+std::ostream& operator<<(std::ostream& out, const Value& value) {
+    return value.isSmall() ? out << value.asSmall() : out << value.toString();
+}
+
+// Parses a decimal literal, only falling back to BigInt for very long ones
+Value parseNumberLiteral(const std::string& digits) {
+    if (digits.size() <= 18) {  // 10^18 - 1 always fits in an int64_t
+        int64_t result = 0;
+        for (char digit : digits) {
+            result = result * 10 + (digit - '0');
+        }
+        return Value(result);
+    }
+    return Value(BigInt::fromString(digits));
+}
+
+Value addValues(const Value& a, const Value& b) {
+    int64_t result;
+    if (a.isSmall() && b.isSmall() && !__builtin_add_overflow(a.asSmall(), b.asSmall(), &result)) {
+        return Value(result);
+    }
+    return Value(BigInt::add(a.toBig(), b.toBig()));
+}
+
+Value subtractValues(const Value& a, const Value& b) {
+    int64_t result;
+    if (a.isSmall() && b.isSmall() && !__builtin_sub_overflow(a.asSmall(), b.asSmall(), &result)) {
+        return Value(result);
+    }
+    return Value(BigInt::subtract(a.toBig(), b.toBig()));
+}
+
+Value multiplyValues(const Value& a, const Value& b) {
+    int64_t result;
+    if (a.isSmall() && b.isSmall() && !__builtin_mul_overflow(a.asSmall(), b.asSmall(), &result)) {
+        return Value(result);
+    }
+    return Value(BigInt::multiply(a.toBig(), b.toBig()));
+}
+
+// Caller must check for division by zero
+Value divideValues(const Value& a, const Value& b) {
+    if (a.isSmall() && b.isSmall()
+        && !(a.asSmall() == std::numeric_limits<int64_t>::min() && b.asSmall() == -1)) {
+        return Value(a.asSmall() / b.asSmall());
+    }
+    return Value(BigInt::divide(a.toBig(), b.toBig()));
+}
+
+// Returns <0, 0 or >0 like strcmp
+int compareValues(const Value& a, const Value& b) {
+    if (a.isSmall() && b.isSmall()) {
+        return (a.asSmall() > b.asSmall()) - (a.asSmall() < b.asSmall());
+    }
+    return BigInt::compare(a.toBig(), b.toBig());
+}
+
 // ==================== AST Node Definitions ====================
 
 // Base class for all AST nodes
 struct ASTNode {
+    ASTNode() {
+        STAT_INC(astNodes);
+    }
+
+    // For placeholders that are not part of any AST, so are not counted
+    struct Uncounted {};
+    explicit ASTNode(Uncounted) {}
+
+    // Counts AST memory for --stats; the matching delete keeps new and
+    // delete paired for -Wmismatched-new-delete
+    static void* operator new(std::size_t size) {
+        STAT_ADD(astAndBigIntBytes, size);
+        return ::operator new(size);
+    }
+
+    static void operator delete(void* ptr) {
+        ::operator delete(ptr);
+    }
+
     virtual ~ASTNode() = default;
 };
 
 // AST Node for Number literals
 struct NumberNode : public ASTNode {
     std::string value;
+    Value parsed;  // Parsed once here rather than on every evaluation
 
-    explicit NumberNode(std::string value) : value(value) {}
+    explicit NumberNode(std::string value) : value(value), parsed(parseNumberLiteral(value)) {}
 };
 
 // AST Node for Variables
@@ -92,21 +621,133 @@ struct CompareNode : public ASTNode {
         : compare(compare), leftSide(leftSide), rightSide(rightSide) {}
 };
 
+// ==================== AST Interning ====================
+
+// Hash-consing table for the immutable AST nodes (expressions, assignments
+// and prints). Children are interned before their parents, so two subtrees are
+// structurally identical exactly when kind, token and child pointers match.
+// Blocks, ifs and whiles are never shared.
+class ASTInterner {
+public:
+    ASTNode* number(const std::string& value) {
+        return intern({NUMBER_NODE, END_OF_FILE, value, nullptr, nullptr},
+                      [&] { return new NumberNode(value); });
+    }
+
+    ASTNode* variable(const std::string& name) {
+        return intern({VARIABLE_NODE, END_OF_FILE, name, nullptr, nullptr},
+                      [&] { return new VariableNode(name); });
+    }
+
+    ASTNode* binaryOp(const Token& op, ASTNode* left, ASTNode* right) {
+        return intern({BINARY_OP_NODE, op.type, "", left, right},
+                      [&] { return new BinaryOpNode(op, left, right); });
+    }
+
+    ASTNode* compare(const Token& compare, ASTNode* leftSide, ASTNode* rightSide) {
+        return intern({COMPARE_NODE, compare.type, "", leftSide, rightSide},
+                      [&] { return new CompareNode(compare, leftSide, rightSide); });
+    }
+
+    ASTNode* assignment(const std::string& variable, ASTNode* expression) {
+        return intern({ASSIGNMENT_NODE, END_OF_FILE, variable, expression, nullptr},
+                      [&] { return new AssignmentNode(variable, expression); });
+    }
+
+    ASTNode* print(ASTNode* expression) {
+        return intern({PRINT_NODE, END_OF_FILE, "", expression, nullptr},
+                      [&] { return new PrintNode(expression); });
+    }
+
+private:
+    enum NodeKind {
+        NUMBER_NODE, VARIABLE_NODE, BINARY_OP_NODE, COMPARE_NODE, ASSIGNMENT_NODE, PRINT_NODE
+    };
+
+    struct NodeKey {
+        NodeKind kind;
+        TokenType op;
+        std::string text;
+        ASTNode* first;
+        ASTNode* second;
+
+        bool operator==(const NodeKey& other) const {
+            return kind == other.kind && op == other.op && first == other.first
+                && second == other.second && text == other.text;
+        }
+    };
+
+    struct NodeKeyHash {
+        size_t operator()(const NodeKey& key) const {
+            size_t hash = std::hash<std::string>()(key.text);
+            hash = hash * 31 + key.kind;
+            hash = hash * 31 + key.op;
+            hash = hash * 31 + std::hash<ASTNode*>()(key.first);
+            hash = hash * 31 + std::hash<ASTNode*>()(key.second);
+            return hash;
+        }
+    };
+
+    std::unordered_map<NodeKey, ASTNode*, NodeKeyHash> nodes;
+
+    template <typename Factory>
+    ASTNode* intern(const NodeKey& key, Factory create) {
+        STAT_INC(internLookups);
+        auto it = nodes.find(key);
+        if (it != nodes.end()) {
+            STAT_INC(internHits);
+            return it->second;
+        }
+
+        ASTNode* node = create();
+        nodes.emplace(key, node);
+        return node;
+    }
+};
+
 // ==================== Parser ====================
 
+// AST Node for an if/else or while body whose parsing is deferred until it
+// first executes (lazy parsing mode)
+struct LazyBlockNode : public ASTNode {
+    std::shared_ptr<const std::vector<Token>> tokens;
+    std::shared_ptr<ASTInterner> interner;
+    size_t start;    // Position of the opening '{'
+    ASTNode* block;  // Parsed body, or nullptr until first executed
+
+    LazyBlockNode(std::shared_ptr<const std::vector<Token>> tokens,
+                  std::shared_ptr<ASTInterner> interner, size_t start)
+        : tokens(tokens), interner(interner), start(start), block(nullptr) {}
+
+    // Returns the parsed body, parsing it on first use
+    ASTNode* materialize();
+};
+
 class Parser {
 public:
     explicit Parser(const std::vector<Token>& tokens)
-        : tokens(tokens), pos(0) {}
+        : tokens(tokens), pos(0), interner(std::make_shared<ASTInterner>()) {}
+
+    // Lazy parsing mode: braced if/else and while bodies become LazyBlockNodes
+    // sharing these tokens and this interner. They are only brace-matched, or
+    // with validateBodies given a syntax-only parse so errors show up now.
+    Parser(std::shared_ptr<const std::vector<Token>> sharedTokens,
+           std::shared_ptr<ASTInterner> interner, size_t start = 0, bool validateBodies = false)
+        : tokens(*sharedTokens), pos(start), interner(interner), sharedTokens(sharedTokens),
+          validateBodies(validateBodies) {}
 
     // Parses the entire program (multiple statements)
     ASTNode* parseProgram() {
         std::vector<ASTNode*> statements;
 
+        uint64_t prefixHash = FNV_OFFSET_BASIS;
         while (currentToken().type != END_OF_FILE) {
+            size_t start = pos;
             ASTNode* statement = parseStatement();
             if (statement) {
                 statements.push_back(statement);
+                prefixHash = hashTokens(prefixHash, start, pos);
+                prefixHashes.push_back(prefixHash);
             } else {
                 // Handle parse error
                 std::cerr << "Error parsing statement\n";
@@ -117,6 +758,12 @@ public:
         return new BlockNode(statements);
     }
 
+    // Hash of the tokens of each top-level statement parsed by parseProgram,
+    // chained with every statement before it
+    const std::vector<uint64_t>& statementPrefixHashes() const {
+        return prefixHashes;
+    }
+
     // Parses a single statement
     ASTNode* parseStatement() {
         switch (currentToken().type) {
@@ -147,7 +794,7 @@ public:
             Token op = currentToken();
             advance();
             ASTNode* right = parseTerm();
-            left = new BinaryOpNode(op, left, right);
+            left = discarding ? discardedNode() : interner->binaryOp(op, left, right);
         }
 
         if (!left) {
@@ -160,6 +807,32 @@ public:
 private:
     const std::vector<Token>& tokens;
     size_t pos;
+    std::shared_ptr<ASTInterner> interner;  // Shares structurally identical subtrees
+    std::shared_ptr<const std::vector<Token>> sharedTokens;  // Only set in lazy mode
+    bool validateBodies = false;
+    bool discarding = false;  // Checking syntax only; no nodes are allocated
+    std::vector<uint64_t> prefixHashes;
+
+    // Stands in for every node built while discarding
+    static ASTNode* discardedNode() {
+        static ASTNode placeholder{ASTNode::Uncounted()};
+        return &placeholder;
+    }
+
+    // FNV-1a, so hashes stay stable across builds and can be persisted
+    static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+    static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    uint64_t hashTokens(uint64_t hash, size_t start, size_t end) const {
+        for (size_t i = start; i < end; i++) {
+            hash = (hash ^ tokens[i].type) * FNV_PRIME;
+            for (char c : tokens[i].value) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * FNV_PRIME;
+            }
+            hash = (hash ^ 0xff) * FNV_PRIME;  // Separates adjacent token values
+        }
+        return hash;
+    }
 
     // Helper functions
     Token currentToken() const {
@@ -192,7 +865,7 @@ private:
             Token op = currentToken();
             advance();
             ASTNode* right = parseFactor();
-            left = new BinaryOpNode(op, left, right);
+            left = discarding ? discardedNode() : interner->binaryOp(op, left, right);
         }
 
         return left;
@@ -202,10 +875,10 @@ private:
         Token token = currentToken();
         if (token.type == NUMBER) {
             advance();
-            return new NumberNode(token.value);
+            return discarding ? discardedNode() : interner->number(token.value);
         } else if (token.type == IDENTIFIER) {
             advance();
-            return new VariableNode(token.value);
+            return discarding ? discardedNode() : interner->variable(token.value);
         } else if (token.type == LPAREN) {
             advance();
             ASTNode* exp = parseExpression();
@@ -224,7 +897,7 @@ private:
         expectToken(ASSIGN, "Expected '=' after identifier");
 
         ASTNode* exp = parseExpression();
-        return new AssignmentNode(var.value, exp);
+        return discarding ? discardedNode() : interner->assignment(var.value, exp);
     }
 
     // Parse conditions for if/while
@@ -234,7 +907,7 @@ private:
             Token compare = currentToken();
             advance();
             ASTNode* rightSide = parseExpression();
-            return new CompareNode(compare, leftSide, rightSide);
+            return discarding ? discardedNode() : interner->compare(compare, leftSide, rightSide);
         }
         return leftSide;
     }
@@ -249,7 +922,7 @@ private:
 
         ASTNode* thenBranch = nullptr;
         if (currentToken().type == LBRACE) {
-            thenBranch = parseBlock();
+            thenBranch = parseBody();
         } else {
             thenBranch = parseStatement();
         }
@@ -258,13 +931,13 @@ private:
         if (isCurrentToken({ELSE})) {
             advance();
             if (currentToken().type == LBRACE) {
-                elseBranch = parseBlock();
+                elseBranch = parseBody();
             } else {
                 elseBranch = parseStatement();
             }
         }
 
-        return new IfNode(condition, thenBranch, elseBranch);
+        return discarding ? discardedNode() : new IfNode(condition, thenBranch, elseBranch);
     }
 
     // Parse while loops
@@ -277,12 +950,43 @@ private:
 
         ASTNode* body = nullptr;
         if (currentToken().type == LBRACE) {
-            body = parseBlock();
+            body = parseBody();
         } else {
             body = parseStatement();
         }
 
-        return new WhileNode(condition, body);
+        return discarding ? discardedNode() : new WhileNode(condition, body);
+    }
+
+    // Parse the braced body of an if/else or while, deferring it in lazy mode
+    ASTNode* parseBody() {
+        if (!sharedTokens || discarding) {
+            return parseBlock();
+        }
+
+        size_t start = pos;
+        if (validateBodies) {
+            discarding = true;
+            parseBlock();
+            discarding = false;
+        } else {
+            int depth = 0;
+            do {
+                if (currentToken().type == LBRACE) {
+                    depth++;
+                } else if (currentToken().type == RBRACE) {
+                    depth--;
+                }
+                advance();
+            } while (depth > 0 && currentToken().type != END_OF_FILE);
+
+            if (depth > 0) {
+                std::cerr << "Error! Expected '}' at end of block, found token: " << currentToken().value << "\n";
+            }
+        }
+
+        STAT_INC(lazyBlocksDeferred);
+        return new LazyBlockNode(sharedTokens, interner, start);
     }
 
     // Parse block of statements
@@ -293,17 +997,18 @@ private:
 
         while (currentToken().type != RBRACE && currentToken().type != END_OF_FILE) {
             ASTNode* statement = parseStatement();
-            if (statement) {
-                statements.push_back(statement);
-            } else {
+            if (!statement) {
                 // Handle parse error
                 std::cerr << "Error parsing statement in block\n";
                 break;
             }
+            if (!discarding) {
+                statements.push_back(statement);
+            }
         }
 
         expectToken(RBRACE, "Expected '}' at end of block");
-        return new BlockNode(statements);
+        return discarding ? discardedNode() : new BlockNode(statements);
     }
 
     // Parse print statements
@@ -316,69 +1021,155 @@ private:
             return nullptr;
         }
 
-        return new PrintNode(expr);
+        return discarding ? discardedNode() : interner->print(expr);
     }
+
+    friend struct LazyBlockNode;
 };
 
+ASTNode* LazyBlockNode::materialize() {
+    if (!block) {
+        STAT_INC(lazyBlocksMaterialized);
+        Parser parser(tokens, interner, start);
+        block = parser.parseBlock();
+    }
+    return block;
+}
+
 // ==================== Evaluator ====================
 
 // Symbol table to store variable values
-std::unordered_map<std::string, int> symbolTable;
+std::unordered_map<std::string, Value> symbolTable;
+
+// Where print statements write; batch mode redirects it per instance
+std::ostream* programOutput = &std::cout;
 
 // Function to evaluate expressions and return integer values
-int evaluateExpression(ASTNode* node);
+Value evaluateExpression(ASTNode* node);
 
-void evaluateAST(ASTNode* node) {
-    if (dynamic_cast<BlockNode*>(node)) {
-        // Handle block node
-        BlockNode* blockNode = static_cast<BlockNode*>(node);
-        for (ASTNode* stmt : blockNode->statements) {
-            evaluateAST(stmt);
-        }
-    }
-    else if (dynamic_cast<AssignmentNode*>(node)) {
-        // Handle assignment node
-        AssignmentNode* assignNode = static_cast<AssignmentNode*>(node);
-        int value = evaluateExpression(assignNode->expression);
-        symbolTable[assignNode->variable] = value;
-    }
-    else if (dynamic_cast<PrintNode*>(node)) {
-        // Handle print node
-        PrintNode* printNode = static_cast<PrintNode*>(node);
-        int value = evaluateExpression(printNode->expression);
-        std::cout << value << std::endl;
-    }
-    else if (dynamic_cast<IfNode*>(node)) {
-        // Handle if node
-        IfNode* ifNode = static_cast<IfNode*>(node);
-        int conditionValue = evaluateExpression(ifNode->condition);
-        if (conditionValue) {
-            evaluateAST(ifNode->thenBranch);
-        } else if (ifNode->elseBranch) {
-            evaluateAST(ifNode->elseBranch);
-        }
-    }
-    else if (dynamic_cast<WhileNode*>(node)) {
-        // Handle while node
-        WhileNode* whileNode = static_cast<WhileNode*>(node);
-        while (evaluateExpression(whileNode->condition)) {
-            evaluateAST(whileNode->body);
-        }
+// Resumable statement executor. Control flow lives on an explicit frame stack
+// rather than the C++ call stack, so a run can stop at any loop back-edge once
+// its instruction budget is spent and pick up again later from the same point.
+// Expressions have no loops and are always evaluated in one go.
+class Execution {
+public:
+    explicit Execution(ASTNode* root) {
+        frames.push_back({root, 0});
     }
-    else {
-        std::cerr << "Error! Unsupported AST Node\n";
+
+    bool finished() const {
+        return frames.empty();
     }
+
+    // Runs until the program finishes or the budget runs out. Every statement
+    // and every loop condition check costs one instruction; the budget is only
+    // checked at loop back-edges, so it may end slightly negative. Returns true
+    // once the program has finished. An optional deadline is also checked at
+    // every back-edge, since a loop whose iterations keep getting slower
+    // (e.g. squaring a BigInt) could otherwise run far past it. The scheduler
+    // always passes one; without a deadline the clock is never read.
+    bool run(int64_t& budget,
+             std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) {
+        bool hasDeadline = deadline != std::chrono::steady_clock::time_point::max();
+        while (!frames.empty()) {
+            ASTNode* node = frames.back().node;
+
+            if (dynamic_cast<BlockNode*>(node)) {
+                // Handle block node
+                BlockNode* blockNode = static_cast<BlockNode*>(node);
+                size_t next = frames.back().next++;
+                if (next < blockNode->statements.size()) {
+                    frames.push_back({blockNode->statements[next], 0});
+                } else {
+                    frames.pop_back();
+                }
+            }
+            else if (dynamic_cast<LazyBlockNode*>(node)) {
+                // Handle lazily parsed block by running its parsed body in place
+                frames.back().node = static_cast<LazyBlockNode*>(node)->materialize();
+            }
+            else if (dynamic_cast<AssignmentNode*>(node)) {
+                // Handle assignment node
+                AssignmentNode* assignNode = static_cast<AssignmentNode*>(node);
+                STAT_INC(statementsExecuted);
+                budget--;
+                frames.pop_back();
+                Value value = evaluateExpression(assignNode->expression);
+                symbolTable[assignNode->variable] = value;
+            }
+            else if (dynamic_cast<PrintNode*>(node)) {
+                // Handle print node
+                PrintNode* printNode = static_cast<PrintNode*>(node);
+                STAT_INC(statementsExecuted);
+                budget--;
+                frames.pop_back();
+                Value value = evaluateExpression(printNode->expression);
+                *programOutput << value << std::endl;
+            }
+            else if (dynamic_cast<IfNode*>(node)) {
+                // Handle if node
+                IfNode* ifNode = static_cast<IfNode*>(node);
+                STAT_INC(statementsExecuted);
+                budget--;
+                frames.pop_back();
+                Value conditionValue = evaluateExpression(ifNode->condition);
+                if (conditionValue.isTruthy()) {
+                    frames.push_back({ifNode->thenBranch, 0});
+                } else if (ifNode->elseBranch) {
+                    frames.push_back({ifNode->elseBranch, 0});
+                }
+            }
+            else if (dynamic_cast<WhileNode*>(node)) {
+                // Handle while node; next counts completed iterations
+                WhileNode* whileNode = static_cast<WhileNode*>(node);
+                if (frames.back().next == 0) {
+                    STAT_INC(statementsExecuted);
+                } else if (budget <= 0 || (hasDeadline && std::chrono::steady_clock::now() >= deadline)) {
+                    return false;  // Safepoint at the loop back-edge
+                }
+                budget--;  // Each condition check costs one, so empty bodies still yield
+
+                if (evaluateExpression(whileNode->condition).isTruthy()) {
+                    STAT_INC(loopIterations);
+                    frames.back().next++;
+                    frames.push_back({whileNode->body, 0});
+                } else {
+                    frames.pop_back();
+                }
+            }
+            else {
+                std::cerr << "Error! Unsupported AST Node\n";
+                frames.pop_back();
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Frame {
+        ASTNode* node;
+        size_t next;  // Next statement of a block, or iterations of a while
+    };
+
+    std::vector<Frame> frames;
+};
+
+// Runs a program to completion
+void evaluateAST(ASTNode* node) {
+    int64_t budget = std::numeric_limits<int64_t>::max();
+    Execution(node).run(budget);
 }
 
-int evaluateExpression(ASTNode* node) {
+Value evaluateExpression(ASTNode* node) {
     if (dynamic_cast<NumberNode*>(node)) {
         NumberNode* numNode = static_cast<NumberNode*>(node);
-        return std::stoi(numNode->value);
+        return numNode->parsed;
     }
     else if (dynamic_cast<VariableNode*>(node)) {
         VariableNode* varNode = static_cast<VariableNode*>(node);
-        if (symbolTable.find(varNode->name) != symbolTable.end()) {
-            return symbolTable[varNode->name];
+        auto it = symbolTable.find(varNode->name);
+        if (it != symbolTable.end()) {
+            return it->second;
         } else {
             std::cerr << "Error! Undefined variable: " << varNode->name << std::endl;
             return 0;
@@ -386,21 +1177,21 @@ int evaluateExpression(ASTNode* node) {
     }
     else if (dynamic_cast<BinaryOpNode*>(node)) {
         BinaryOpNode* binOpNode = static_cast<BinaryOpNode*>(node);
-        int leftValue = evaluateExpression(binOpNode->left);
-        int rightValue = evaluateExpression(binOpNode->right);
+        Value leftValue = evaluateExpression(binOpNode->left);
+        Value rightValue = evaluateExpression(binOpNode->right);
         switch (binOpNode->op.type) {
             case PLUS:
-                return leftValue + rightValue;
+                return addValues(leftValue, rightValue);
             case MINUS:
-                return leftValue - rightValue;
+                return subtractValues(leftValue, rightValue);
             case MULTIPLY:
-                return leftValue * rightValue;
+                return multiplyValues(leftValue, rightValue);
             case DIVIDE:
-                if (rightValue == 0) {
+                if (!rightValue.isTruthy()) {
                     std::cerr << "Error! Division by zero\n";
                     return 0;
                 }
-                return leftValue / rightValue;
+                return divideValues(leftValue, rightValue);
             default:
                 std::cerr << "Error! Unsupported binary operator\n";
                 return 0;
@@ -408,13 +1199,13 @@ int evaluateExpression(ASTNode* node) {
     }
     else if (dynamic_cast<CompareNode*>(node)) {
         CompareNode* compNode = static_cast<CompareNode*>(node);
-        int leftValue = evaluateExpression(compNode->leftSide);
-        int rightValue = evaluateExpression(compNode->rightSide);
+        Value leftValue = evaluateExpression(compNode->leftSide);
+        Value rightValue = evaluateExpression(compNode->rightSide);
         switch (compNode->compare.type) {
             case GEQ:
-                return leftValue >= rightValue;
+                return compareValues(leftValue, rightValue) >= 0;
             case LEQ:
-                return leftValue <= rightValue;
+                return compareValues(leftValue, rightValue) <= 0;
             // Handle other comparison operators if needed
             default:
                 std::cerr << "Error! Unsupported comparison operator\n";
@@ -427,6 +1218,622 @@ int evaluateExpression(ASTNode* node) {
     }
 }
 
+// ==================== Batch Execution ====================
+
+// Initial variable bindings for batch mode: one instance per CSV row, with
+// the variable names taken from the header row
+struct BatchInputs {
+    std::vector<std::string> names;
+    std::vector<std::vector<Value>> rows;
+};
+
+// Parses an optionally negative decimal integer, returning false if malformed
+bool parseBatchValue(std::string text, Value& value) {
+    text.erase(0, text.find_first_not_of(" \t\r"));
+    text.erase(text.find_last_not_of(" \t\r") + 1);
+
+    bool negative = !text.empty() && text[0] == '-';
+    std::string digits = negative ? text.substr(1) : text;
+    if (digits.empty() || !std::all_of(digits.begin(), digits.end(), ::isdigit)) {
+        return false;
+    }
+
+    value = parseNumberLiteral(digits);
+    if (negative) {
+        value = subtractValues(0, value);
+    }
+    return true;
+}
+
+bool loadBatchInputs(const std::string& filename, BatchInputs& inputs) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open batch input file " << filename << "\n";
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(file, line)) {
+        std::cerr << "Error: Batch input file " << filename << " has no header row\n";
+        return false;
+    }
+
+    std::stringstream header(line);
+    std::string name;
+    while (std::getline(header, name, ',')) {
+        name.erase(0, name.find_first_not_of(" \t\r"));
+        name.erase(name.find_last_not_of(" \t\r") + 1);
+        inputs.names.push_back(name);
+    }
+
+    size_t lineNumber = 1;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        std::vector<Value> row;
+        std::stringstream fields(line);
+        std::string field;
+        while (std::getline(fields, field, ',')) {
+            Value value;
+            if (!parseBatchValue(field, value)) {
+                std::cerr << "Error: Invalid integer '" << field << "' on line " << lineNumber
+                          << " of " << filename << "\n";
+                return false;
+            }
+            row.push_back(value);
+        }
+
+        if (row.size() != inputs.names.size()) {
+            std::cerr << "Error: Expected " << inputs.names.size() << " values on line "
+                      << lineNumber << " of " << filename << ", found " << row.size() << "\n";
+            return false;
+        }
+        inputs.rows.push_back(row);
+    }
+
+    return true;
+}
+
+// Number of instances evaluated in lock-step; masks select which lanes each
+// statement affects once instances diverge at an if or while. The per-lane
+// loops have this fixed trip count and no cross-lane dependencies, but the
+// 64-bit add, subtract, compare and mask loops only vectorise on targets with
+// 64-bit lane compares (e.g. -march=x86-64-v3 with GCC); baseline x86-64 keeps
+// them scalar. Multiply (checked with __builtin_mul_overflow) and divide are
+// always scalar.
+constexpr size_t BATCH_WIDTH = 64;
+
+struct LaneValues {
+    int64_t lanes[BATCH_WIDTH];
+};
+
+struct LaneMask {
+    uint8_t lanes[BATCH_WIDTH];
+
+    bool any() const {
+        uint8_t result = 0;
+        for (size_t i = 0; i < BATCH_WIDTH; i++) {
+            result |= lanes[i];
+        }
+        return result != 0;
+    }
+};
+
+// Runs one program over up to BATCH_WIDTH instances at once. Lanes that would
+// leave the 64-bit fast path (overflow, division by zero, reading an unbound
+// variable, BigInt inputs) are marked for fallback, dropped from the batch and
+// re-run afterwards by the scalar evaluator, so results match a normal run.
+class BatchExecutor {
+public:
+    BatchExecutor() : columns(), fallback(), output() {}
+
+    // Binds an input variable for one lane
+    void bind(const std::string& name, size_t lane, const Value& value) {
+        Column& column = columns[name];
+        if (value.isSmall()) {
+            column.values.lanes[lane] = value.asSmall();
+            column.defined.lanes[lane] = 1;
+        } else {
+            fallback.lanes[lane] = 1;
+        }
+    }
+
+    void run(ASTNode* root, const LaneMask& active) {
+        execute(root, active);
+    }
+
+    bool needsFallback(size_t lane) const {
+        return fallback.lanes[lane] != 0;
+    }
+
+    const std::string& laneOutput(size_t lane) const {
+        return output[lane];
+    }
+
+private:
+    struct Column {
+        LaneValues values = {};
+        LaneMask defined = {};
+    };
+
+    std::unordered_map<std::string, Column> columns;
+    LaneMask fallback;
+    std::string output[BATCH_WIDTH];
+
+    // Lanes from mask that are still running in the batch
+    LaneMask live(const LaneMask& mask) const {
+        LaneMask result;
+        for (size_t i = 0; i < BATCH_WIDTH; i++) {
+            result.lanes[i] = mask.lanes[i] & !fallback.lanes[i];
+        }
+        return result;
+    }
+
+    void markFallback(const LaneMask& mask, const uint8_t* failed) {
+        for (size_t i = 0; i < BATCH_WIDTH; i++) {
+            fallback.lanes[i] |= mask.lanes[i] & failed[i];
+        }
+    }
+
+    void execute(ASTNode* node, const LaneMask& mask) {
+        if (dynamic_cast<BlockNode*>(node)) {
+            BlockNode* blockNode = static_cast<BlockNode*>(node);
+            for (ASTNode* stmt : blockNode->statements) {
+                execute(stmt, mask);
+            }
+        }
+        else if (dynamic_cast<LazyBlockNode*>(node)) {
+            execute(static_cast<LazyBlockNode*>(node)->materialize(), mask);
+        }
+        else if (dynamic_cast<AssignmentNode*>(node)) {
+            AssignmentNode* assignNode = static_cast<AssignmentNode*>(node);
+            LaneValues value = evaluate(assignNode->expression, mask);
+            LaneMask active = live(mask);
+            Column& column = columns[assignNode->variable];
+            for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                column.values.lanes[i] = active.lanes[i] ? value.lanes[i] : column.values.lanes[i];
+                column.defined.lanes[i] |= active.lanes[i];
+            }
+        }
+        else if (dynamic_cast<PrintNode*>(node)) {
+            PrintNode* printNode = static_cast<PrintNode*>(node);
+            LaneValues value = evaluate(printNode->expression, mask);
+            LaneMask active = live(mask);
+            for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                if (active.lanes[i]) {
+                    output[i] += std::to_string(value.lanes[i]) + "\n";
+                }
+            }
+        }
+        else if (dynamic_cast<IfNode*>(node)) {
+            IfNode* ifNode = static_cast<IfNode*>(node);
+            LaneValues condition = evaluate(ifNode->condition, mask);
+            LaneMask active = live(mask);
+            LaneMask thenMask, elseMask;
+            for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                thenMask.lanes[i] = active.lanes[i] & (condition.lanes[i] != 0);
+                elseMask.lanes[i] = active.lanes[i] & (condition.lanes[i] == 0);
+            }
+            if (thenMask.any()) {
+                execute(ifNode->thenBranch, thenMask);
+            }
+            if (ifNode->elseBranch && elseMask.any()) {
+                execute(ifNode->elseBranch, elseMask);
+            }
+        }
+        else if (dynamic_cast<WhileNode*>(node)) {
+            WhileNode* whileNode = static_cast<WhileNode*>(node);
+            LaneMask loopMask = live(mask);
+            while (true) {
+                LaneValues condition = evaluate(whileNode->condition, loopMask);
+                loopMask = live(loopMask);
+                for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                    loopMask.lanes[i] &= condition.lanes[i] != 0;
+                }
+                if (!loopMask.any()) {
+                    break;
+                }
+                execute(whileNode->body, loopMask);
+            }
+        }
+        else {
+            std::cerr << "Error! Unsupported AST Node\n";
+        }
+    }
+
+    LaneValues evaluate(ASTNode* node, const LaneMask& mask) {
+        LaneValues result = {};
+
+        if (dynamic_cast<NumberNode*>(node)) {
+            NumberNode* numNode = static_cast<NumberNode*>(node);
+            const Value& value = numNode->parsed;
+            if (!value.isSmall()) {
+                LaneMask all;
+                std::fill(std::begin(all.lanes), std::end(all.lanes), 1);
+                markFallback(mask, all.lanes);
+                return result;
+            }
+            std::fill(std::begin(result.lanes), std::end(result.lanes), value.asSmall());
+        }
+        else if (dynamic_cast<VariableNode*>(node)) {
+            VariableNode* varNode = static_cast<VariableNode*>(node);
+            Column& column = columns[varNode->name];
+            uint8_t undefined[BATCH_WIDTH];
+            for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                undefined[i] = !column.defined.lanes[i];
+            }
+            markFallback(mask, undefined);
+            result = column.values;
+        }
+        else if (dynamic_cast<BinaryOpNode*>(node)) {
+            BinaryOpNode* binOpNode = static_cast<BinaryOpNode*>(node);
+            LaneValues left = evaluate(binOpNode->left, mask);
+            LaneValues right = evaluate(binOpNode->right, mask);
+            uint8_t failed[BATCH_WIDTH];
+            switch (binOpNode->op.type) {
+                case PLUS:
+                    for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                        int64_t a = left.lanes[i], b = right.lanes[i];
+                        int64_t sum = static_cast<int64_t>(uint64_t(a) + uint64_t(b));
+                        result.lanes[i] = sum;
+                        failed[i] = ((a ^ sum) & (b ^ sum)) < 0;
+                    }
+                    break;
+                case MINUS:
+                    for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                        int64_t a = left.lanes[i], b = right.lanes[i];
+                        int64_t difference = static_cast<int64_t>(uint64_t(a) - uint64_t(b));
+                        result.lanes[i] = difference;
+                        failed[i] = ((a ^ b) & (a ^ difference)) < 0;
+                    }
+                    break;
+                case MULTIPLY:
+                    for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                        failed[i] = __builtin_mul_overflow(left.lanes[i], right.lanes[i], &result.lanes[i]);
+                    }
+                    break;
+                case DIVIDE:
+                    for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                        int64_t a = left.lanes[i], b = right.lanes[i];
+                        failed[i] = b == 0 || (a == std::numeric_limits<int64_t>::min() && b == -1);
+                        result.lanes[i] = a / (failed[i] ? 1 : b);
+                    }
+                    break;
+                default:
+                    std::cerr << "Error! Unsupported binary operator\n";
+                    return result;
+            }
+            markFallback(mask, failed);
+        }
+        else if (dynamic_cast<CompareNode*>(node)) {
+            CompareNode* compNode = static_cast<CompareNode*>(node);
+            LaneValues left = evaluate(compNode->leftSide, mask);
+            LaneValues right = evaluate(compNode->rightSide, mask);
+            switch (compNode->compare.type) {
+                case GEQ:
+                    for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                        result.lanes[i] = left.lanes[i] >= right.lanes[i];
+                    }
+                    break;
+                case LEQ:
+                    for (size_t i = 0; i < BATCH_WIDTH; i++) {
+                        result.lanes[i] = left.lanes[i] <= right.lanes[i];
+                    }
+                    break;
+                default:
+                    std::cerr << "Error! Unsupported comparison operator\n";
+                    break;
+            }
+        }
+        else {
+            std::cerr << "Error! Unsupported expression type\n";
+        }
+
+        return result;
+    }
+};
+
+// Runs the program once per input row and writes every line an instance
+// prints to stdout as "<instance index>\t<line>", grouped by instance
+void runBatch(ASTNode* root, const BatchInputs& inputs) {
+    for (size_t base = 0; base < inputs.rows.size(); base += BATCH_WIDTH) {
+        size_t count = std::min(BATCH_WIDTH, inputs.rows.size() - base);
+
+        BatchExecutor executor;
+        LaneMask active = {};
+        for (size_t lane = 0; lane < count; lane++) {
+            active.lanes[lane] = 1;
+            for (size_t column = 0; column < inputs.names.size(); column++) {
+                executor.bind(inputs.names[column], lane, inputs.rows[base + lane][column]);
+            }
+        }
+        executor.run(root, active);
+
+        for (size_t lane = 0; lane < count; lane++) {
+            std::string laneOutput = executor.laneOutput(lane);
+
+            if (executor.needsFallback(lane)) {
+                // Re-run this instance from scratch on the scalar evaluator
+                symbolTable.clear();
+                for (size_t column = 0; column < inputs.names.size(); column++) {
+                    symbolTable[inputs.names[column]] = inputs.rows[base + lane][column];
+                }
+                std::ostringstream captured;
+                programOutput = &captured;
+                evaluateAST(root);
+                programOutput = &std::cout;
+                laneOutput = captured.str();
+            }
+
+            std::stringstream lines(laneOutput);
+            std::string line;
+            while (std::getline(lines, line)) {
+                std::cout << base + lane << "\t" << line << "\n";
+            }
+        }
+    }
+    std::cout.flush();
+}
+
+// ==================== Scheduler ====================
+
+struct SchedulerOptions {
+    int64_t sliceInstructions = 10000;  // Instructions per time slice
+    int64_t sliceMicros = 2000;         // Wall-clock length of a time slice
+    int64_t maxInstructions = 0;        // Per-program instruction budget, 0 for none
+    int64_t maxMillis = 0;              // Per-program time budget, 0 for none
+};
+
+// A program interleaved with others by the scheduler. Each keeps its own
+// variables and output, swapped into the evaluator's globals for its slice.
+struct ScheduledProgram {
+    size_t index;
+    std::string name;
+    Execution execution;
+    std::unordered_map<std::string, Value> variables;
+    std::ostringstream output;
+    int64_t instructionsUsed = 0;
+    uint64_t microsUsed = 0;  // Time spent inside this program's own slices
+
+    ScheduledProgram(size_t index, const std::string& name, ASTNode* root)
+        : index(index), name(name), execution(root) {}
+};
+
+// Writes what a program printed during its last slice as "<index>\t<line>"
+void flushScheduledOutput(ScheduledProgram& program) {
+    std::stringstream lines(program.output.str());
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::cout << program.index << "\t" << line << "\n";
+    }
+    program.output.str("");
+    std::cout.flush();
+}
+
+// Round-robin scheduler interleaving many programs on one thread. A program
+// gives up the CPU at the first loop back-edge after spending its slice, and
+// is stopped for good once it exceeds its instruction or time budget.
+void runScheduled(std::deque<ScheduledProgram>& programs, const SchedulerOptions& options) {
+    std::deque<ScheduledProgram*> ready;
+    for (ScheduledProgram& program : programs) {
+        ready.push_back(&program);
+    }
+
+    while (!ready.empty()) {
+        ScheduledProgram& program = *ready.front();
+        ready.pop_front();
+
+        int64_t sliceBudget = options.sliceInstructions;
+        if (options.maxInstructions > 0) {
+            sliceBudget = std::min(sliceBudget, options.maxInstructions - program.instructionsUsed);
+        }
+
+        std::swap(symbolTable, program.variables);
+        programOutput = &program.output;
+        auto start = std::chrono::steady_clock::now();
+        // A slice ends after its instructions or its time, whichever comes
+        // first, and never runs past the program's remaining time budget
+        auto deadline = start + std::chrono::microseconds(options.sliceMicros);
+        if (options.maxMillis > 0) {
+            deadline = std::min(deadline, start + std::chrono::microseconds(
+                                              options.maxMillis * 1000 - program.microsUsed));
+        }
+
+        int64_t budget = sliceBudget;
+        bool finished = program.execution.run(budget, deadline);
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        programOutput = &std::cout;
+        std::swap(symbolTable, program.variables);
+
+        uint64_t sliceMicros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        recordSliceLatency(sliceMicros);
+        program.microsUsed += sliceMicros;
+        program.instructionsUsed += sliceBudget - budget;
+        flushScheduledOutput(program);
+
+        if (finished) {
+            continue;
+        }
+        if (options.maxInstructions > 0 && program.instructionsUsed >= options.maxInstructions) {
+            std::cerr << "Error: " << program.name << " exceeded its instruction budget of "
+                      << options.maxInstructions << ", stopping it\n";
+        } else if (options.maxMillis > 0 && program.microsUsed >= uint64_t(options.maxMillis) * 1000) {
+            std::cerr << "Error: " << program.name << " exceeded its time budget of "
+                      << options.maxMillis << "ms, stopping it\n";
+        } else {
+            ready.push_back(&program);
+        }
+    }
+}
+
+// ==================== Checkpoints ====================
+
+// State after one top-level statement of the root block. The prefix hash
+// covers that statement and everything before it, so a checkpoint can be
+// reused exactly when the source up to that point is unchanged.
+struct Checkpoint {
+    uint64_t prefixHash;
+    std::string output;  // What this statement printed
+    std::vector<std::pair<std::string, Value>> variables;
+};
+
+const char* const CHECKPOINT_HEADER = "ecolang-checkpoint 1";
+
+// Reads checkpoints saved by a previous run. A missing or unreadable file
+// just means there is nothing to resume from.
+std::vector<Checkpoint> loadCheckpoints(const std::string& filename) {
+    std::vector<Checkpoint> checkpoints;
+    std::ifstream file(filename, std::ios::binary);
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line) || line != CHECKPOINT_HEADER) {
+        return checkpoints;
+    }
+
+    // Output sizes are checked against what is left in the file before
+    // allocating, so a corrupt size cannot exhaust memory
+    std::streampos recordsStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streampos fileEnd = file.tellg();
+    file.seekg(recordsStart);
+
+    Checkpoint checkpoint;
+    size_t outputSize, variableCount;
+    while (file >> checkpoint.prefixHash >> outputSize >> variableCount && file.get() == '\n') {
+        if (outputSize > static_cast<size_t>(fileEnd - file.tellg())) {
+            std::cerr << "Warning: Ignoring corrupt checkpoint file " << filename << "\n";
+            return {};
+        }
+        checkpoint.output.resize(outputSize);
+        file.read(&checkpoint.output[0], outputSize);
+        if (static_cast<size_t>(file.gcount()) != outputSize) {
+            std::cerr << "Warning: Ignoring corrupt checkpoint file " << filename << "\n";
+            return {};
+        }
+
+        checkpoint.variables.clear();
+        for (size_t i = 0; i < variableCount && file; i++) {
+            std::string name, text;
+            Value value;
+            if (file >> name >> text && !parseBatchValue(text, value)) {
+                std::cerr << "Warning: Ignoring corrupt checkpoint file " << filename << "\n";
+                return {};
+            }
+            checkpoint.variables.push_back({name, value});
+        }
+
+        // Records end with a marker, so one cut short by an interrupted run
+        // is dropped rather than half-restored
+        std::string marker;
+        if (!(file >> marker) || marker != "end") {
+            break;
+        }
+        checkpoints.push_back(checkpoint);
+    }
+    return checkpoints;
+}
+
+void writeCheckpoint(std::ostream& out, const Checkpoint& checkpoint) {
+    out << checkpoint.prefixHash << " " << checkpoint.output.size() << " "
+        << checkpoint.variables.size() << "\n" << checkpoint.output;
+    for (const auto& variable : checkpoint.variables) {
+        out << variable.first << " " << variable.second << "\n";
+    }
+    out << "end\n";
+    out.flush();  // Each record is usable even if the run is interrupted
+}
+
+// Stream buffer that forwards everything to another buffer and keeps a copy
+// of what was written since the last takeRecorded()
+class RecordingBuffer : public std::streambuf {
+public:
+    explicit RecordingBuffer(std::streambuf* target) : target(target) {}
+
+    std::string takeRecorded() {
+        std::string recorded;
+        recorded.swap(text);
+        return recorded;
+    }
+
+protected:
+    int overflow(int ch) override {
+        if (ch == traits_type::eof()) {
+            return traits_type::not_eof(ch);
+        }
+        text += static_cast<char>(ch);
+        return target->sputc(static_cast<char>(ch));
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override {
+        text.append(data, count);
+        return target->sputn(data, count);
+    }
+
+    int sync() override {
+        return target->pubsync();
+    }
+
+private:
+    std::streambuf* target;
+    std::string text;
+};
+
+// Runs the program, saving a checkpoint after every top-level statement. The
+// run resumes after the last saved statement whose source prefix still
+// matches, replaying the output printed up to there instead of recomputing it.
+void runWithCheckpoints(ASTNode* root, const std::vector<uint64_t>& prefixHashes,
+                        const std::string& filename) {
+    BlockNode* program = dynamic_cast<BlockNode*>(root);
+    std::vector<Checkpoint> saved = loadCheckpoints(filename);
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Warning: Could not write checkpoint file " << filename
+                  << ", running without checkpoints\n";
+        evaluateAST(root);
+        return;
+    }
+    file << CHECKPOINT_HEADER << "\n";
+
+    size_t resumeFrom = 0;
+    while (resumeFrom < saved.size() && resumeFrom < prefixHashes.size()
+           && saved[resumeFrom].prefixHash == prefixHashes[resumeFrom]) {
+        resumeFrom++;
+    }
+    STAT_ADD(statementsResumed, resumeFrom);
+
+    for (size_t i = 0; i < resumeFrom; i++) {
+        std::cout << saved[i].output;
+        writeCheckpoint(file, saved[i]);
+    }
+    std::cout.flush();
+    if (resumeFrom > 0) {
+        symbolTable.clear();
+        for (const auto& variable : saved[resumeFrom - 1].variables) {
+            symbolTable[variable.first] = variable.second;
+        }
+    }
+
+    RecordingBuffer recorder(std::cout.rdbuf());
+    std::ostream recordingOutput(&recorder);
+    programOutput = &recordingOutput;
+
+    for (size_t i = resumeFrom; i < program->statements.size(); i++) {
+        evaluateAST(program->statements[i]);
+
+        Checkpoint checkpoint;
+        checkpoint.prefixHash = prefixHashes[i];
+        checkpoint.output = recorder.takeRecorded();
+        checkpoint.variables.assign(symbolTable.begin(), symbolTable.end());
+        writeCheckpoint(file, checkpoint);
+    }
+
+    programOutput = &std::cout;
+}
+
 // ==================== Main Function ====================
 
 // Function to load source code from a file
@@ -442,34 +1849,200 @@ std::string loadSourceCode(const std::string& filename) {
     return buffer.str();
 }
 
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        std::cerr << "Error: No source file provided\n";
-        return 1;
-    }
+struct ParseOptions {
+    bool lazyBlocks = false;  // Defer if/else and while bodies until first executed
+    bool validate = false;    // Lazy mode only: syntax-check deferred bodies up front
+};
 
+// Loads, tokenizes and parses a program, returning nullptr on failure.
+// Optionally also returns the parser's top-level statement prefix hashes.
+ASTNode* loadProgram(const std::string& filename, const ParseOptions& options,
+                     std::vector<uint64_t>* prefixHashes = nullptr) {
     // Load the source code from the provided file
-    std::string sourceCode = loadSourceCode(argv[1]);
+    std::string sourceCode;
+    {
+        PhaseTimer timer(runtimeStats.loadMicros);
+        sourceCode = loadSourceCode(filename);
+    }
 
     if (sourceCode.empty()) {
         std::cerr << "Error: Empty or invalid source file\n";
-        return 1;
+        return nullptr;
     }
 
     // Tokenize the source code
-    Lexer lexer(sourceCode);
-    std::vector<Token> tokens = lexer.tokenize();
+    std::vector<Token> tokens;
+    {
+        PhaseTimer timer(runtimeStats.lexMicros);
+        Lexer lexer(sourceCode);
+        tokens = lexer.tokenize();
+        STAT_ADD(tokens, tokens.size());
+    }
 
     // Parse the tokens into an AST
-    Parser parser(tokens);
-    ASTNode* root = parser.parseProgram();
-
-    // Evaluate the AST
-    if (root) {
-        evaluateAST(root);  // Run the program by evaluating the root node
+    PhaseTimer timer(runtimeStats.parseMicros);
+    std::unique_ptr<Parser> parser;
+    if (options.lazyBlocks) {
+        auto sharedTokens = std::make_shared<const std::vector<Token>>(std::move(tokens));
+        parser.reset(new Parser(sharedTokens, std::make_shared<ASTInterner>(), 0, options.validate));
     } else {
+        parser.reset(new Parser(tokens));
+    }
+
+    ASTNode* root = parser->parseProgram();
+    if (!root) {
         std::cerr << "Error: Parsing failed\n";
+    } else if (prefixHashes) {
+        *prefixHashes = parser->statementPrefixHashes();
+    }
+    return root;
+}
+
+// Parses the value of a numeric "--name=N" option, which must be positive
+bool parseCountOption(const std::string& arg, int64_t& value) {
+    std::string digits = arg.substr(arg.find('=') + 1);
+    if (digits.empty() || digits.size() > 18 || !std::all_of(digits.begin(), digits.end(), ::isdigit)
+        || (value = std::stoll(digits)) <= 0) {
+        std::cerr << "Error: Expected a positive integer in " << arg << "\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> sourceFiles;
+    std::string batchFile;
+    std::string checkpointFile;
+    bool printStats = false;
+    bool schedule = false;
+    ParseOptions parseOptions;
+    SchedulerOptions schedulerOptions;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--stats=", 0) == 0) {
+            if (arg != "--stats=json") {
+                std::cerr << "Error: Unsupported stats format in " << arg << "\n";
+                return 1;
+            }
+            if (!ECOLANG_STATS) {
+                std::cerr << "Error: Interpreter was built without statistics support\n";
+                return 1;
+            }
+            printStats = true;
+        } else if (arg.rfind("--batch=", 0) == 0) {
+            batchFile = arg.substr(8);
+        } else if (arg.rfind("--checkpoint=", 0) == 0) {
+            checkpointFile = arg.substr(13);
+        } else if (arg == "--lazy-blocks") {
+            parseOptions.lazyBlocks = true;
+        } else if (arg == "--validate") {
+            parseOptions.validate = true;
+        } else if (arg == "--schedule") {
+            schedule = true;
+        } else if (arg.rfind("--slice=", 0) == 0) {
+            if (!parseCountOption(arg, schedulerOptions.sliceInstructions)) {
+                return 1;
+            }
+        } else if (arg.rfind("--max-instructions=", 0) == 0) {
+            if (!parseCountOption(arg, schedulerOptions.maxInstructions)) {
+                return 1;
+            }
+        } else if (arg.rfind("--slice-micros=", 0) == 0) {
+            if (!parseCountOption(arg, schedulerOptions.sliceMicros)) {
+                return 1;
+            }
+        } else if (arg.rfind("--max-millis=", 0) == 0) {
+            if (!parseCountOption(arg, schedulerOptions.maxMillis)) {
+                return 1;
+            }
+        } else {
+            sourceFiles.push_back(arg);
+        }
     }
 
-    return 0;
-}
\ No newline at end of file
+    // Every exit from here on reports stats, so failed runs show up too
+    auto finish = [&](int exitStatus) {
+        if (printStats) {
+            printStatsJson(std::cerr, exitStatus);
+        }
+        return exitStatus;
+    };
+
+    if (sourceFiles.empty()) {
+        std::cerr << "Error: No source file provided\n";
+        return finish(1);
+    }
+    if (sourceFiles.size() > 1 && !schedule) {
+        std::cerr << "Error: Multiple source files need --schedule\n";
+        return finish(1);
+    }
+    if (schedule && !batchFile.empty()) {
+        std::cerr << "Error: --schedule and --batch cannot be combined\n";
+        return finish(1);
+    }
+
+    if (parseOptions.validate && !parseOptions.lazyBlocks) {
+        std::cerr << "Error: --validate only applies with --lazy-blocks\n";
+        return finish(1);
+    }
+    if (!checkpointFile.empty() && (schedule || !batchFile.empty())) {
+        std::cerr << "Error: --checkpoint cannot be combined with --schedule or --batch\n";
+        return finish(1);
+    }
+
+    if (schedule) {
+        // Interleave every program on this thread, each within its own budgets
+        // Programs that fail to load are skipped, but the run still fails.
+        // Output is tagged with each program's position on the command line.
+        std::deque<ScheduledProgram> programs;
+        bool allLoaded = true;
+        for (size_t i = 0; i < sourceFiles.size(); i++) {
+            ASTNode* root = loadProgram(sourceFiles[i], parseOptions);
+            if (root) {
+                programs.emplace_back(i, sourceFiles[i], root);
+            } else {
+                allLoaded = false;
+            }
+        }
+
+        {
+            PhaseTimer timer(runtimeStats.evalMicros);
+            runScheduled(programs, schedulerOptions);
+        }
+        if (!allLoaded) {
+            return finish(1);
+        }
+    } else {
+        // Load the initial variable bindings for batch mode
+        BatchInputs batchInputs;
+        if (!batchFile.empty()) {
+            bool loaded;
+            {
+                PhaseTimer timer(runtimeStats.loadMicros);
+                loaded = loadBatchInputs(batchFile, batchInputs);
+            }
+            if (!loaded) {
+                return finish(1);
+            }
+        }
+
+        std::vector<uint64_t> prefixHashes;
+        ASTNode* root = loadProgram(sourceFiles[0], parseOptions, &prefixHashes);
+        if (!root) {
+            return finish(1);
+        }
+
+        // Evaluate the AST
+        PhaseTimer timer(runtimeStats.evalMicros);
+        if (!batchFile.empty()) {
+            runBatch(root, batchInputs);
+        } else if (!checkpointFile.empty()) {
+            runWithCheckpoints(root, prefixHashes, checkpointFile);
+        } else {
+            evaluateAST(root);  // Run the program by evaluating the root node
+        }
+    }
+
+    return finish(0);
+}